@@ -0,0 +1,192 @@
+#include "block_sort.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Her karakter için bucket başlangıç (end = false) veya bitiş (end = true) konumları
+void getBuckets(const int32_t* s, std::vector<int32_t>& bkt, int32_t n, int32_t K, bool end) {
+    std::fill(bkt.begin(), bkt.begin() + K, 0);
+    for (int32_t i = 0; i < n; ++i) ++bkt[s[i]];
+    int32_t sum = 0;
+    for (int32_t i = 0; i < K; ++i) {
+        sum += bkt[i];
+        bkt[i] = end ? sum : sum - bkt[i];
+    }
+}
+
+void induceL(const std::vector<bool>& t, int32_t* SA, const int32_t* s, std::vector<int32_t>& bkt, int32_t n, int32_t K) {
+    getBuckets(s, bkt, n, K, false);
+    for (int32_t i = 0; i < n; ++i) {
+        int32_t j = SA[i] - 1;
+        if (j >= 0 && !t[j]) SA[bkt[s[j]]++] = j;
+    }
+}
+
+void induceS(const std::vector<bool>& t, int32_t* SA, const int32_t* s, std::vector<int32_t>& bkt, int32_t n, int32_t K) {
+    getBuckets(s, bkt, n, K, true);
+    for (int32_t i = n - 1; i >= 0; --i) {
+        int32_t j = SA[i] - 1;
+        if (j >= 0 && t[j]) SA[--bkt[s[j]]] = j;
+    }
+}
+
+// SA-IS (Nong, Zhang, Chan): s[n - 1] tek ve en küçük karakter (0) olmalıdır, K alfabe boyutudur
+void suffixArray(const int32_t* s, int32_t* SA, int32_t n, int32_t K) {
+    // t[i] == true: S tipi, false: L tipi
+    std::vector<bool> t(n);
+    t[n - 1] = true;
+    for (int32_t i = n - 2; i >= 0; --i) {
+        t[i] = s[i] < s[i + 1] || (s[i] == s[i + 1] && t[i + 1]);
+    }
+    auto isLMS = [&t](int32_t i) { return i > 0 && t[i] && !t[i - 1]; };
+
+    // 1. adım: LMS alt dizilerini sırala
+    std::vector<int32_t> bkt(K);
+    getBuckets(s, bkt, n, K, true);
+    std::fill(SA, SA + n, -1);
+    for (int32_t i = 1; i < n; ++i) {
+        if (isLMS(i)) SA[--bkt[s[i]]] = i;
+    }
+    induceL(t, SA, s, bkt, n, K);
+    induceS(t, SA, s, bkt, n, K);
+
+    // Sıralı LMS alt dizilerini dizinin başına topla ve isimlendir
+    int32_t n1 = 0;
+    for (int32_t i = 0; i < n; ++i) {
+        if (isLMS(SA[i])) SA[n1++] = SA[i];
+    }
+    std::fill(SA + n1, SA + n, -1);
+    int32_t name = 0;
+    int32_t prev = -1;
+    for (int32_t i = 0; i < n1; ++i) {
+        int32_t pos = SA[i];
+        bool diff = false;
+        for (int32_t d = 0; d < n; ++d) {
+            if (prev == -1 || s[pos + d] != s[prev + d] || t[pos + d] != t[prev + d]) {
+                diff = true;
+                break;
+            }
+            if (d > 0 && (isLMS(pos + d) || isLMS(prev + d))) break;
+        }
+        if (diff) {
+            ++name;
+            prev = pos;
+        }
+        SA[n1 + pos / 2] = name - 1;
+    }
+    for (int32_t i = n - 1, j = n - 1; i >= n1; --i) {
+        if (SA[i] >= 0) SA[j--] = SA[i];
+    }
+
+    // 2. adım: isimler tekil değilse indirgenmiş dizi için özyinelemeli çöz
+    int32_t* s1 = SA + n - n1;
+    if (name < n1) {
+        suffixArray(s1, SA, n1, name);
+    } else {
+        for (int32_t i = 0; i < n1; ++i) SA[s1[i]] = i;
+    }
+
+    // 3. adım: LMS sıralamasından tüm suffix array'i türet
+    getBuckets(s, bkt, n, K, true);
+    for (int32_t i = 1, j = 0; i < n; ++i) {
+        if (isLMS(i)) s1[j++] = i;
+    }
+    for (int32_t i = 0; i < n1; ++i) SA[i] = s1[SA[i]];
+    std::fill(SA + n1, SA + n, -1);
+    for (int32_t i = n1 - 1; i >= 0; --i) {
+        int32_t j = SA[i];
+        SA[i] = -1;
+        SA[--bkt[s[j]]] = j;
+    }
+    induceL(t, SA, s, bkt, n, K);
+    induceS(t, SA, s, bkt, n, K);
+}
+
+// Ters BWT: her satır için (sonraki satır << 8 | ilk karakter) tek bir kelimede tutulur,
+// böylece çıktı byte'ı başına yalnızca bir rastgele bellek erişimi yapılır (bzip2'deki tt dizisi gibi)
+template <typename Word>
+std::vector<char> inverseWithWord(const std::vector<char>& data, uint32_t primaryIndex) {
+    size_t n = data.size();
+    size_t counts[256] = {};
+    for (char c : data) ++counts[static_cast<unsigned char>(c)];
+    // Satır 0 sentinel ile başlayan rotasyondur
+    size_t next[256];
+    size_t sum = 1;
+    for (int c = 0; c < 256; ++c) {
+        next[c] = sum;
+        sum += counts[c];
+    }
+    std::vector<Word> tt(n + 1);
+    tt[0] = static_cast<Word>(primaryIndex) << 8;
+    for (size_t i = 0, row = 0; row <= n; ++row) {
+        if (row == primaryIndex) continue;
+        unsigned char c = static_cast<unsigned char>(data[i++]);
+        tt[next[c]++] = (static_cast<Word>(row) << 8) | c;
+    }
+    std::vector<char> out(n);
+    Word p = tt[0] >> 8;
+    for (size_t k = 0; k < n; ++k) {
+        Word w = tt[p];
+        out[k] = static_cast<char>(w & 0xFF);
+        p = w >> 8;
+    }
+    return out;
+}
+
+} // namespace
+
+std::vector<char> bwtForward(const std::vector<char>& data, uint32_t& primaryIndex) {
+    int32_t n = static_cast<int32_t>(data.size());
+    primaryIndex = 0;
+    if (n == 0) return std::vector<char>();
+    // Byte'lar 1..256 aralığına kaydırılır, sona tek ve en küçük sentinel (0) eklenir
+    std::vector<int32_t> s(n + 1);
+    for (int32_t i = 0; i < n; ++i) s[i] = static_cast<unsigned char>(data[i]) + 1;
+    s[n] = 0;
+    std::vector<int32_t> SA(n + 1);
+    suffixArray(s.data(), SA.data(), n + 1, 257);
+    // Son sütun: her suffix'ten önceki karakter; sentinel'in düştüğü satır primaryIndex olarak saklanır
+    std::vector<char> out(n);
+    for (int32_t i = 0, j = 0; i <= n; ++i) {
+        if (SA[i] == 0) {
+            primaryIndex = static_cast<uint32_t>(i);
+        } else {
+            out[j++] = data[SA[i] - 1];
+        }
+    }
+    return out;
+}
+
+std::vector<char> bwtInverse(const std::vector<char>& data, uint32_t primaryIndex) {
+    if (data.empty()) return std::vector<char>();
+    if (data.size() + 1 < (size_t(1) << 24)) {
+        return inverseWithWord<uint32_t>(data, primaryIndex);
+    }
+    return inverseWithWord<uint64_t>(data, primaryIndex);
+}
+
+void mtfEncode(std::vector<char>& data) {
+    unsigned char order[256];
+    for (int i = 0; i < 256; ++i) order[i] = static_cast<unsigned char>(i);
+    for (char& ch : data) {
+        unsigned char c = static_cast<unsigned char>(ch);
+        unsigned char rank = 0;
+        while (order[rank] != c) ++rank;
+        std::memmove(order + 1, order, rank);
+        order[0] = c;
+        ch = static_cast<char>(rank);
+    }
+}
+
+void mtfDecode(std::vector<char>& data) {
+    unsigned char order[256];
+    for (int i = 0; i < 256; ++i) order[i] = static_cast<unsigned char>(i);
+    for (char& ch : data) {
+        unsigned char rank = static_cast<unsigned char>(ch);
+        unsigned char c = order[rank];
+        std::memmove(order + 1, order, rank);
+        order[0] = c;
+        ch = static_cast<char>(c);
+    }
+}
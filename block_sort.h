@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Blok sıralama (Burrows-Wheeler) dönüşümü ve move-to-front kodlaması.
+// Metin verisinde BWT benzer bağlamları yan yana getirir, MTF bunları küçük değerlere (çoğunlukla 0) çevirir;
+// böylece sonraki run-length aşaması uzun diziler bulur.
+
+// Suffix array SA-IS algoritmasıyla doğrusal zamanda kurulur.
+// primaryIndex: orijinal verinin sıralı rotasyonlar içindeki satırı, ters dönüşüm için gereklidir.
+std::vector<char> bwtForward(const std::vector<char>& data, uint32_t& primaryIndex);
+std::vector<char> bwtInverse(const std::vector<char>& data, uint32_t primaryIndex);
+
+void mtfEncode(std::vector<char>& data);
+void mtfDecode(std::vector<char>& data);
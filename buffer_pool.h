@@ -0,0 +1,37 @@
+#pragma once
+#include <mutex>
+#include <vector>
+
+// Chunk tamponlarını işler arasında yeniden kullanmak için havuz.
+// Daemon modunda her istek için yeni bellek ayırmak yerine önceki işlerin tamponları (kapasiteleriyle) geri alınır.
+class BufferPool {
+public:
+    explicit BufferPool(size_t maxBytes) : maxBytes_(maxBytes), heldBytes_(0) {}
+
+    std::vector<char> acquire(size_t size) {
+        std::vector<char> buffer;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_.empty()) {
+                buffer = std::move(free_.back());
+                free_.pop_back();
+                heldBytes_ -= buffer.capacity();
+            }
+        }
+        buffer.resize(size);
+        return buffer;
+    }
+
+    void release(std::vector<char>&& buffer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (buffer.capacity() == 0 || heldBytes_ + buffer.capacity() > maxBytes_) return;
+        heldBytes_ += buffer.capacity();
+        free_.push_back(std::move(buffer));
+    }
+
+private:
+    std::vector<std::vector<char>> free_;
+    size_t maxBytes_;
+    size_t heldBytes_;
+    std::mutex mutex_;
+};
@@ -0,0 +1,108 @@
+#include "checksum.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CRC32C_X86 1
+#include <nmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace {
+
+// Castagnoli polinomu (ters bit sırası)
+constexpr uint32_t CRC32C_POLY = 0x82F63B78u;
+
+// Slice-by-8 tabloları: yazılım yolunda her adımda 8 byte işlenir
+struct Crc32cTables {
+    uint32_t t[8][256];
+    Crc32cTables() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int k = 0; k < 8; ++k) {
+                crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLY : 0);
+            }
+            t[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; ++i) {
+            for (int s = 1; s < 8; ++s) {
+                t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xFF];
+            }
+        }
+    }
+};
+
+const Crc32cTables& tables() {
+    static const Crc32cTables instance;
+    return instance;
+}
+
+uint32_t crc32cSoftware(const unsigned char* p, size_t size, uint32_t crc) {
+    const auto& t = tables().t;
+    while (size >= 8) {
+        uint32_t lo = (static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+                       static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24) ^ crc;
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+              t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+        p += 8;
+        size -= 8;
+    }
+    while (size--) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+    }
+    return crc;
+}
+
+#ifdef CRC32C_X86
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("sse4.2")))
+#endif
+uint32_t crc32cHardware(const unsigned char* p, size_t size, uint32_t crc) {
+    uint64_t crc64 = crc;
+    while (size >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        p += 8;
+        size -= 8;
+    }
+    uint32_t crc32 = static_cast<uint32_t>(crc64);
+    while (size--) {
+        crc32 = _mm_crc32_u8(crc32, *p++);
+    }
+    return crc32;
+}
+
+bool detectSse42() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#else
+    return __builtin_cpu_supports("sse4.2");
+#endif
+}
+#endif
+
+} // namespace
+
+bool crc32cHardwareAccelerated() {
+#ifdef CRC32C_X86
+    static const bool supported = detectSse42();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+uint32_t crc32c(const char* data, size_t size, uint32_t crc) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    crc = ~crc;
+#ifdef CRC32C_X86
+    if (crc32cHardwareAccelerated()) {
+        return ~crc32cHardware(p, size, crc);
+    }
+#endif
+    return ~crc32cSoftware(p, size, crc);
+}
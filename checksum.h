@@ -0,0 +1,11 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// CRC32C (Castagnoli) sağlama toplamı.
+// SSE4.2 destekleyen x86 işlemcilerde donanım komutu (crc32) kullanılır, diğerlerinde tablo tabanlı hesaplanır.
+// crc parametresi ile parça parça hesaplama yapılabilir: crc32c(b, nb, crc32c(a, na)) == crc32c(a+b)
+uint32_t crc32c(const char* data, size_t size, uint32_t crc = 0);
+
+// Donanım hızlandırmalı yolun kullanılıp kullanılmadığını döndürür (bilgi amaçlı)
+bool crc32cHardwareAccelerated();
@@ -4,12 +4,146 @@
 #include <algorithm>
 #include <thread>
 #include <chrono>
+#include <cstring>
+#include <atomic>
+#include "checksum.h"
+#include "block_sort.h"
+#include "thread_pool.h"
+#include "buffer_pool.h"
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <winioctl.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
-Compressor::Compressor(const std::string& inputFile, const std::string& outputFile, size_t chunkSize)
-    : inputFile_(inputFile), outputFile_(outputFile), chunkSize_(chunkSize), fileSize_(0), chunkCount_(0), progressBar_(nullptr) {}
+// Sparse çıktı için blok boyutu: dosya ofsetine hizalı ve tamamen sıfır olan bloklar diske yazılmaz
+constexpr size_t SPARSE_BLOCK_SIZE = 4096;
 
-std::vector<char> Compressor::runLengthEncode(const std::vector<char>& data) {
-    std::vector<char> encoded;
+// Sıkıştırılmış dosya formatı (little-endian):
+//   Başlık (32 byte): "RLC\0" | version u32 | flags u32 | indeks CRC32C u32 | chunkSize u64 | chunkCount u64
+//   İndeks (chunk başına 24 byte): rawSize u64 | compressedSize u64 | rawCrc u32 | compressedCrc u32
+//   Ardından sıkıştırılmış chunk'lar sırayla
+// FLAG_BLOCK_SORT ayarlıysa her chunk BWT + MTF sonrası RLE ile kodlanır ve başında
+// BWT primary index'i (u32) bulunur; NO_TRANSFORM değeri chunk'ın dönüşümsüz RLE ile saklandığını belirtir
+// Magic'in 4. byte'ı (bir RLE çiftinin sayı byte'ı) sıfırdır; eski indekssiz RLE akışında sayı hiçbir zaman 0 olmadığı
+// için eski bir dosya yanlışlıkla konteyner olarak algılanamaz
+constexpr char CONTAINER_MAGIC[4] = {'R', 'L', 'C', '\0'};
+constexpr uint32_t CONTAINER_VERSION = 1;
+constexpr size_t HEADER_SIZE = 32;
+constexpr size_t INDEX_ENTRY_SIZE = 24;
+constexpr uint32_t FLAG_BLOCK_SORT = 1;
+constexpr uint32_t NO_TRANSFORM = 0xFFFFFFFFu;
+constexpr size_t PRIMARY_INDEX_SIZE = 4;
+
+// Doğrulamada tek görevin işlediği yaklaşık sıkıştırılmış veri miktarı
+constexpr uint64_t VERIFY_BATCH_BYTES = 4 * 1024 * 1024; // 4MB
+
+namespace {
+void putU32(char* p, uint32_t value) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<char>(value >> (8 * i));
+}
+
+void putU64(char* p, uint64_t value) {
+    for (int i = 0; i < 8; ++i) p[i] = static_cast<char>(value >> (8 * i));
+}
+
+uint32_t getU32(const char* p) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    return value;
+}
+
+uint64_t getU64(const char* p) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) value |= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    return value;
+}
+
+bool isZeroBlock(const char* data, size_t size) {
+    static const char zeros[SPARSE_BLOCK_SIZE] = {};
+    return std::memcmp(data, zeros, size) == 0;
+}
+
+#ifndef _WIN32
+// Atlanan bölgelerin dosyada gerçekten boşluk olarak kalıp kalmadığını kontrol eder.
+// Sparse desteklemeyen dosya sistemleri bu bölgeleri sıfırla doldurur, SEEK_HOLE ilk boşluk olarak dosya sonunu döndürür.
+bool hasHoles(const std::string& path, size_t size) {
+#ifdef SEEK_HOLE
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    off_t hole = lseek(fd, 0, SEEK_HOLE);
+    ::close(fd);
+    return hole >= 0 && static_cast<size_t>(hole) < size;
+#else
+    (void)path;
+    (void)size;
+    return false;
+#endif
+}
+#endif
+
+// Chunk görevlerini paylaşılan havuz varsa onda, yoksa her görev için ayrı bir thread ile çalıştırır
+class ChunkTasks {
+public:
+    explicit ChunkTasks(ThreadPool* pool) : pool_(pool), group_(pool ? pool->createGroup() : nullptr) {}
+    // Görev gönderildikten sonra exception fırlatılırsa (ör. bad_alloc) görevler yerel değişkenler yok edilmeden bitirilir
+    ~ChunkTasks() {
+        for (auto& t : threads_) {
+            if (t.joinable()) t.join();
+        }
+        if (pool_) {
+            try {
+                pool_->wait(group_);
+            } catch (...) {
+            }
+        }
+    }
+    void run(std::function<void()> task) {
+        if (pool_) {
+            pool_->submit(group_, std::move(task));
+        } else {
+            threads_.emplace_back(std::move(task));
+        }
+    }
+    void join() {
+        for (auto& t : threads_) t.join();
+        threads_.clear();
+        if (pool_) pool_->wait(group_);
+    }
+private:
+    ThreadPool* pool_;
+    std::shared_ptr<ThreadPool::Group> group_;
+    std::vector<std::thread> threads_;
+};
+}
+
+Compressor::Compressor(const std::string& inputFile, const std::string& outputFile, size_t chunkSize, bool blockSort)
+    : inputFile_(inputFile), outputFile_(outputFile), chunkSize_(chunkSize), fileSize_(0), chunkCount_(0), blockSort_(blockSort), corrupt_(false),
+      progressBar_(nullptr), pool_(nullptr), buffers_(nullptr), out_(&std::cout), outputOffset_(0), holeBytes_(0), pendingHole_(false) {}
+
+void Compressor::setThreadPool(ThreadPool* pool, BufferPool* buffers) {
+    pool_ = pool;
+    buffers_ = buffers;
+}
+
+void Compressor::setOutput(std::ostream& out) {
+    out_ = &out;
+}
+
+std::vector<char> Compressor::acquireBuffer(size_t size) {
+    if (buffers_) return buffers_->acquire(size);
+    return std::vector<char>(size);
+}
+
+void Compressor::releaseBuffer(std::vector<char>&& buffer) {
+    if (buffers_) buffers_->release(std::move(buffer));
+}
+
+void Compressor::runLengthEncode(const std::vector<char>& data, std::vector<char>& encoded) {
+    encoded.clear();
     size_t n = data.size();
     for (size_t i = 0; i < n;) {
         char current = data[i];
@@ -21,68 +155,123 @@ std::vector<char> Compressor::runLengthEncode(const std::vector<char>& data) {
         encoded.push_back(static_cast<char>(run));
         i += run;
     }
-    return encoded;
 }
 
-void Compressor::compressChunk(size_t chunkIndex, const std::vector<char>& chunkData, std::vector<char>& compressedData) {
-    compressedData = runLengthEncode(chunkData);
-    // İlerleme çubuğunu güncelle
-    if (progressBar_) {
-        std::lock_guard<std::mutex> lock(writeMutex_);
-        progressBar_->update(chunkIndex + 1);
+void Compressor::compressChunk(const std::vector<char>& chunkData, std::vector<char>& compressedData, ChunkEntry& entry) {
+    runLengthEncode(chunkData, compressedData);
+    if (blockSort_) {
+        // BWT + MTF sonrası RLE; dönüşüm chunk'ı küçültmüyorsa (ör. rastgele veri) düz RLE saklanır
+        uint32_t primaryIndex = 0;
+        std::vector<char> transformed = bwtForward(chunkData, primaryIndex);
+        mtfEncode(transformed);
+        std::vector<char> encoded;
+        runLengthEncode(transformed, encoded);
+        if (encoded.size() >= compressedData.size()) {
+            primaryIndex = NO_TRANSFORM;
+            encoded.swap(compressedData);
+        }
+        compressedData.resize(PRIMARY_INDEX_SIZE);
+        putU32(compressedData.data(), primaryIndex);
+        compressedData.insert(compressedData.end(), encoded.begin(), encoded.end());
     }
+    // Chunk'ın ham ve sıkıştırılmış hali için sağlama toplamları
+    entry.rawSize = chunkData.size();
+    entry.compressedSize = compressedData.size();
+    entry.rawCrc = crc32c(chunkData.data(), chunkData.size());
+    entry.compressedCrc = crc32c(compressedData.data(), compressedData.size());
 }
 
-void Compressor::compress(bool multithread) {
-    std::cout << "[INFO] Opening input file: " << inputFile_ << std::endl;
+bool Compressor::writeContainer(const std::vector<ChunkEntry>& index, const std::vector<std::vector<char>>& chunks) {
+    std::ofstream outFile(outputFile_, std::ios::binary);
+    if (!outFile) {
+        *out_ << "[ERROR] Cannot open output file!\n";
+        return false;
+    }
+    std::vector<char> table(index.size() * INDEX_ENTRY_SIZE);
+    for (size_t i = 0; i < index.size(); ++i) {
+        char* p = table.data() + i * INDEX_ENTRY_SIZE;
+        putU64(p, index[i].rawSize);
+        putU64(p + 8, index[i].compressedSize);
+        putU32(p + 16, index[i].rawCrc);
+        putU32(p + 20, index[i].compressedCrc);
+    }
+    char header[HEADER_SIZE] = {};
+    std::memcpy(header, CONTAINER_MAGIC, sizeof(CONTAINER_MAGIC));
+    putU32(header + 4, CONTAINER_VERSION);
+    putU32(header + 8, blockSort_ ? FLAG_BLOCK_SORT : 0);
+    putU32(header + 12, crc32c(table.data(), table.size()));
+    putU64(header + 16, chunkSize_);
+    putU64(header + 24, index.size());
+    outFile.write(header, HEADER_SIZE);
+    outFile.write(table.data(), table.size());
+    for (const auto& chunk : chunks) {
+        outFile.write(chunk.data(), chunk.size());
+    }
+    if (!outFile) {
+        *out_ << "[ERROR] Failed to write output file!\n";
+        return false;
+    }
+    return true;
+}
+
+bool Compressor::compress(bool multithread) {
+    corrupt_ = false;
+    *out_ << "[INFO] Opening input file: " << inputFile_ << std::endl;
     std::ifstream inFile(inputFile_, std::ios::binary | std::ios::ate);
     if (!inFile) {
-        std::cout << "[ERROR] Cannot open input file!\n";
-        return;
+        *out_ << "[ERROR] Cannot open input file!\n";
+        return false;
     }
     fileSize_ = inFile.tellg();
-    std::cout << "[INFO] Input file size: " << fileSize_ << " bytes" << std::endl;
+    *out_ << "[INFO] Input file size: " << fileSize_ << " bytes" << std::endl;
     inFile.seekg(0, std::ios::beg);
     chunkCount_ = (fileSize_ + chunkSize_ - 1) / chunkSize_;
-    std::cout << "[INFO] Chunk size: " << chunkSize_ << ", Chunk count: " << chunkCount_ << std::endl;
+    *out_ << "[INFO] Chunk size: " << chunkSize_ << ", Chunk count: " << chunkCount_ << std::endl;
     if (chunkCount_ == 0) {
-        std::cout << "[ERROR] Chunk count is zero! Nothing to compress.\n";
-        return;
+        *out_ << "[ERROR] Chunk count is zero! Nothing to compress.\n";
+        return false;
     }
+    std::vector<std::vector<char>> compressedChunks(chunkCount_);
+    std::vector<ChunkEntry> index(chunkCount_);
     if (!multithread) {
-        std::vector<char> inputData(fileSize_);
-        inFile.read(inputData.data(), fileSize_);
-        std::vector<char> compressed = runLengthEncode(inputData);
-        std::ofstream outFile(outputFile_, std::ios::binary);
-        if (!outFile) {
-            std::cout << "[ERROR] Cannot open output file!\n";
-            return;
-        }
-        outFile.write(compressed.data(), compressed.size());
-        std::cout << "[INFO] Compression finished!\n";
-        return;
+        // Tek thread: chunk'lar sırayla sıkıştırılır, çıktı formatı multithread ile aynıdır
+        std::vector<char> chunkData;
+        for (size_t i = 0; i < chunkCount_; ++i) {
+            size_t thisChunkSize = std::min(chunkSize_, fileSize_ - i * chunkSize_);
+            chunkData.resize(thisChunkSize);
+            inFile.read(chunkData.data(), thisChunkSize);
+            compressChunk(chunkData, compressedChunks[i], index[i]);
+        }
+        if (!writeContainer(index, compressedChunks)) return false;
+        *out_ << "[INFO] Compression finished!\n";
+        return true;
     }
     // Multithread compress
-    std::vector<std::vector<char>> compressedChunks(chunkCount_);
-    std::vector<std::thread> threads(chunkCount_);
+    // chunkDone görevlerden önce tanımlanır, böylece ChunkTasks yok edilirken hâlâ geçerlidir
     std::vector<bool> chunkDone(chunkCount_, false);
-    progressBar_ = new ProgressBar(chunkCount_);
+    ChunkTasks tasks(pool_);
+    if (out_ == &std::cout) {
+        progressBar_ = new ProgressBar(chunkCount_);
+    }
     for (size_t i = 0; i < chunkCount_; ++i) {
         size_t thisChunkSize = std::min(chunkSize_, fileSize_ - i * chunkSize_);
-        std::vector<char> chunkData(thisChunkSize);
+        std::vector<char> chunkData = acquireBuffer(thisChunkSize);
         inFile.read(chunkData.data(), thisChunkSize);
-        threads[i] = std::thread([this, i, chunkData, &compressedChunks, &chunkDone]() mutable {
-            std::vector<char> compressed;
-            this->compressChunk(i, chunkData, compressed);
+        tasks.run([this, i, chunkData = std::move(chunkData), &compressedChunks, &index, &chunkDone]() mutable {
+            std::vector<char> compressed = this->acquireBuffer(0);
+            ChunkEntry entry;
+            this->compressChunk(chunkData, compressed, entry);
+            this->releaseBuffer(std::move(chunkData));
             {
                 std::lock_guard<std::mutex> lock(this->writeMutex_);
                 compressedChunks[i] = std::move(compressed);
+                index[i] = entry;
                 chunkDone[i] = true;
             }
         });
     }
     // Ana thread ilerleme çubuğunu günceller
-    size_t lastProgress = 0;
+    size_t lastProgress = progressBar_ ? 0 : chunkCount_;
     while (lastProgress < chunkCount_) {
         size_t done = 0;
         {
@@ -97,113 +286,479 @@ void Compressor::compress(bool multithread) {
         }
         std::this_thread::sleep_for(std::chrono::milliseconds(50));
     }
-    for (auto& t : threads) t.join();
-    progressBar_->done();
-    delete progressBar_;
-    std::ofstream outFile(outputFile_, std::ios::binary);
-    if (!outFile) {
-        std::cout << "[ERROR] Cannot open output file!\n";
-        return;
-    }
-    for (const auto& chunk : compressedChunks) {
-        outFile.write(chunk.data(), chunk.size());
+    tasks.join();
+    if (progressBar_) {
+        progressBar_->done();
+        delete progressBar_;
+        progressBar_ = nullptr;
     }
-    std::cout << "[INFO] Compression finished!\n";
+    bool written = writeContainer(index, compressedChunks);
+    for (auto& chunk : compressedChunks) releaseBuffer(std::move(chunk));
+    if (!written) return false;
+    *out_ << "[INFO] Compression finished!\n";
+    return true;
 }
 
-std::vector<char> Compressor::runLengthDecode(const std::vector<char>& data) {
-    std::vector<char> decoded;
-    size_t n = data.size();
+void Compressor::runLengthDecode(const char* data, size_t n, std::vector<char>& decoded) {
+    decoded.clear();
     for (size_t i = 0; i + 1 < n; i += 2) {
         char value = data[i];
         unsigned char count = static_cast<unsigned char>(data[i + 1]);
         decoded.insert(decoded.end(), count, value);
     }
-    return decoded;
 }
 
-void Compressor::decompressChunk(size_t chunkIndex, const std::vector<char>& chunkData, std::vector<char>& decompressedData) {
-    decompressedData = runLengthDecode(chunkData);
+bool Compressor::openSparseOutput(std::ofstream& outFile) {
+    outputOffset_ = 0;
+    holeBytes_ = 0;
+    pendingHole_ = false;
+    sparseTail_.clear();
+#ifdef _WIN32
+    // NTFS'te boşluk bırakmak için dosyanın önce sparse olarak işaretlenmesi gerekir
+    bool sparse = false;
+    HANDLE hFile = CreateFileA(outputFile_.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL,
+                               CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        // Dosya oluşturulamadı (ör. erişim reddedildi); outFile açılmadığı için çağıran açma hatası bildirir
+        return false;
+    }
+    DWORD bytesReturned = 0;
+    sparse = DeviceIoControl(hFile, FSCTL_SET_SPARSE, NULL, 0, NULL, 0, &bytesReturned, NULL) != 0;
+    CloseHandle(hFile);
+    // Dosya zaten oluşturuldu, truncate ederek sparse özelliğini kaybetmemek için in|out ile açıyoruz
+    outFile.open(outputFile_, std::ios::binary | std::ios::in | std::ios::out);
+    if (!sparse) {
+        *out_ << "[WARN] Filesystem does not support sparse files, zero runs will be written in full\n";
+    }
+    return sparse;
+#else
+    // POSIX: dosya sonunun ötesine seek edilen bölgeler, destekleyen dosya sistemlerinde boşluk olarak kalır.
+    // Desteklemeyen dosya sistemleri bu bölgeleri kendisi sıfırla doldurur, bu yüzden içerik yine doğrudur;
+    // boşlukların oluşup oluşmadığı finishSparse'ta kontrol edilir.
+    outFile.open(outputFile_, std::ios::binary | std::ios::trunc);
+    return true;
+#endif
+}
+
+void Compressor::writeSparseBlock(std::ofstream& outFile, const char* block, size_t offset) {
+    if (isZeroBlock(block, SPARSE_BLOCK_SIZE)) {
+        pendingHole_ = true;
+        holeBytes_ += SPARSE_BLOCK_SIZE;
+        return;
+    }
+    if (pendingHole_) {
+        outFile.seekp(static_cast<std::streamoff>(offset), std::ios::beg);
+        pendingHole_ = false;
+    }
+    outFile.write(block, SPARSE_BLOCK_SIZE);
+}
+
+void Compressor::writeSparse(std::ofstream& outFile, const std::vector<char>& data, bool sparse) {
+    const char* p = data.data();
+    size_t n = data.size();
+    if (!sparse) {
+        outFile.write(p, n);
+        outputOffset_ += n;
+        return;
+    }
+    // Bloklar dosya ofsetine göre hizalıdır; chunk sınırına denk gelen yarım blok bir sonraki chunk ile tamamlanır.
+    // Her zaman outputOffset_ % SPARSE_BLOCK_SIZE == sparseTail_.size() geçerlidir.
+    if (!sparseTail_.empty()) {
+        size_t take = std::min(n, SPARSE_BLOCK_SIZE - sparseTail_.size());
+        sparseTail_.insert(sparseTail_.end(), p, p + take);
+        p += take;
+        n -= take;
+        outputOffset_ += take;
+        if (sparseTail_.size() < SPARSE_BLOCK_SIZE) return;
+        writeSparseBlock(outFile, sparseTail_.data(), outputOffset_ - SPARSE_BLOCK_SIZE);
+        sparseTail_.clear();
+    }
+    for (; n >= SPARSE_BLOCK_SIZE; p += SPARSE_BLOCK_SIZE, n -= SPARSE_BLOCK_SIZE) {
+        writeSparseBlock(outFile, p, outputOffset_);
+        outputOffset_ += SPARSE_BLOCK_SIZE;
+    }
+    sparseTail_.assign(p, p + n);
+    outputOffset_ += n;
+}
+
+bool Compressor::finishSparse(std::ofstream& outFile, bool sparse) {
+    // Dosya sonundaki yarım blok boşluk olamaz, olduğu gibi yazılır
+    if (!sparseTail_.empty()) {
+        if (pendingHole_) {
+            outFile.seekp(static_cast<std::streamoff>(outputOffset_ - sparseTail_.size()), std::ios::beg);
+            pendingHole_ = false;
+        }
+        outFile.write(sparseTail_.data(), sparseTail_.size());
+        sparseTail_.clear();
+    }
+    // Dosya bir boşlukla bitiyorsa boyutun doğru olması için son byte'ı açıkça yaz
+    if (pendingHole_ && outputOffset_ > 0) {
+        outFile.seekp(static_cast<std::streamoff>(outputOffset_ - 1), std::ios::beg);
+        outFile.put('\0');
+        pendingHole_ = false;
+    }
+    outFile.flush();
+    if (!outFile) return false;
+    if (sparse && holeBytes_ > 0) {
+#ifndef _WIN32
+        if (!hasHoles(outputFile_, outputOffset_)) {
+            *out_ << "[WARN] Filesystem does not support sparse files, " << holeBytes_
+                  << " zero bytes were written in full\n";
+            return true;
+        }
+#endif
+        *out_ << "[INFO] Sparse output: " << holeBytes_ << " zero bytes left as holes" << std::endl;
+    }
+    return true;
+}
+
+Compressor::ContainerStatus Compressor::readContainer(std::ifstream& inFile, std::vector<ChunkEntry>& index) {
+    char header[HEADER_SIZE];
+    inFile.seekg(0, std::ios::beg);
+    if (fileSize_ < HEADER_SIZE || !inFile.read(header, HEADER_SIZE) ||
+        std::memcmp(header, CONTAINER_MAGIC, sizeof(CONTAINER_MAGIC)) != 0) {
+        // Eski sürümlerin yazdığı indekssiz dosya
+        inFile.clear();
+        inFile.seekg(0, std::ios::beg);
+        blockSort_ = false;
+        return ContainerStatus::Legacy;
+    }
+    uint32_t version = getU32(header + 4);
+    if (version != CONTAINER_VERSION) {
+        *out_ << "[ERROR] Unsupported compressed file version: " << version << std::endl;
+        return ContainerStatus::Corrupt;
+    }
+    uint32_t flags = getU32(header + 8);
+    if (flags & ~FLAG_BLOCK_SORT) {
+        *out_ << "[ERROR] Unsupported compressed file flags: " << flags << std::endl;
+        return ContainerStatus::Corrupt;
+    }
+    uint32_t indexCrc = getU32(header + 12);
+    uint64_t chunkSize = getU64(header + 16);
+    uint64_t chunkCount = getU64(header + 24);
+    if (chunkCount > (fileSize_ - HEADER_SIZE) / INDEX_ENTRY_SIZE) {
+        *out_ << "[ERROR] Corrupt header: chunk count " << chunkCount << " does not fit in file\n";
+        return ContainerStatus::Corrupt;
+    }
+    std::vector<char> table(chunkCount * INDEX_ENTRY_SIZE);
+    inFile.read(table.data(), table.size());
+    if (!inFile || crc32c(table.data(), table.size()) != indexCrc) {
+        *out_ << "[ERROR] Corrupt chunk index: checksum mismatch\n";
+        return ContainerStatus::Corrupt;
+    }
+    index.resize(chunkCount);
+    uint64_t offset = HEADER_SIZE + table.size();
+    for (size_t i = 0; i < chunkCount; ++i) {
+        const char* p = table.data() + i * INDEX_ENTRY_SIZE;
+        index[i].rawSize = getU64(p);
+        index[i].compressedSize = getU64(p + 8);
+        index[i].rawCrc = getU32(p + 16);
+        index[i].compressedCrc = getU32(p + 20);
+        index[i].offset = offset;
+        offset += index[i].compressedSize;
+    }
+    // Kesilmiş dosyada indeks sağlamdır: dosya sonunu aşan chunk'lar tek tek bozuk olarak raporlanır
+    if (offset > fileSize_) {
+        *out_ << "[WARN] Compressed file is truncated: index describes " << offset
+              << " bytes, file has " << fileSize_ << " bytes\n";
+    } else if (offset < fileSize_) {
+        *out_ << "[WARN] " << (fileSize_ - offset) << " trailing bytes after the last chunk are ignored\n";
+    }
+    chunkSize_ = chunkSize;
+    chunkCount_ = chunkCount;
+    blockSort_ = (flags & FLAG_BLOCK_SORT) != 0;
+    return ContainerStatus::Valid;
+}
+
+void Compressor::readChunk(std::ifstream& inFile, const ChunkEntry& entry, std::vector<char>& chunkData) {
+    // Dosya sonunu aşan chunk'lardan yalnızca mevcut byte'lar okunur, eksik kısım kontrol sırasında raporlanır
+    uint64_t available = entry.offset < fileSize_ ? std::min<uint64_t>(entry.compressedSize, fileSize_ - entry.offset) : 0;
+    chunkData.resize(available);
+    inFile.seekg(entry.offset, std::ios::beg);
+    inFile.read(chunkData.data(), chunkData.size());
+    if (!inFile) {
+        inFile.clear();
+        chunkData.resize(inFile.gcount());
+    }
+}
+
+std::string Compressor::checkCompressedChunk(const ChunkEntry& entry, const std::vector<char>& chunkData) {
+    if (chunkData.size() != entry.compressedSize) {
+        return "chunk extends past end of file (" + std::to_string(chunkData.size()) + " of "
+               + std::to_string(entry.compressedSize) + " bytes present)";
+    }
+    if (crc32c(chunkData.data(), chunkData.size()) != entry.compressedCrc) {
+        return "compressed data checksum mismatch";
+    }
+    size_t start = 0;
+    if (blockSort_) {
+        if (chunkData.size() < PRIMARY_INDEX_SIZE) {
+            return "missing block sort header";
+        }
+        uint32_t primaryIndex = getU32(chunkData.data());
+        if (primaryIndex != NO_TRANSFORM && primaryIndex > entry.rawSize) {
+            return "invalid block sort primary index";
+        }
+        start = PRIMARY_INDEX_SIZE;
+    }
+    // RLE çiftlerinden açılmış boyutu hesapla (veriyi açmadan); BWT ve MTF boyutu değiştirmez
+    if ((chunkData.size() - start) % 2 != 0) {
+        return "odd compressed size";
+    }
+    uint64_t decodedSize = 0;
+    for (size_t i = start + 1; i < chunkData.size(); i += 2) {
+        decodedSize += static_cast<unsigned char>(chunkData[i]);
+    }
+    if (decodedSize != entry.rawSize) {
+        return "decoded size mismatch";
+    }
+    return std::string();
+}
+
+bool Compressor::decompressChunk(const ChunkEntry* entry, const std::vector<char>& chunkData,
+                                 std::vector<char>& decompressedData, std::string& error) {
+    if (entry) {
+        error = checkCompressedChunk(*entry, chunkData);
+        if (!error.empty()) {
+            return false;
+        }
+    }
+    if (blockSort_ && chunkData.size() >= PRIMARY_INDEX_SIZE) {
+        uint32_t primaryIndex = getU32(chunkData.data());
+        runLengthDecode(chunkData.data() + PRIMARY_INDEX_SIZE, chunkData.size() - PRIMARY_INDEX_SIZE, decompressedData);
+        if (primaryIndex != NO_TRANSFORM) {
+            mtfDecode(decompressedData);
+            decompressedData = bwtInverse(decompressedData, primaryIndex);
+        }
+    } else {
+        runLengthDecode(chunkData.data(), chunkData.size(), decompressedData);
+    }
+    if (entry && crc32c(decompressedData.data(), decompressedData.size()) != entry->rawCrc) {
+        error = "decompressed data checksum mismatch";
+        return false;
+    }
+    return true;
 }
 
-void Compressor::decompress(bool multithread) {
-    std::cout << "[INFO] Opening compressed file: " << inputFile_ << std::endl;
+bool Compressor::decompress(bool multithread) {
+    corrupt_ = false;
+    *out_ << "[INFO] Opening compressed file: " << inputFile_ << std::endl;
     std::ifstream inFile(inputFile_, std::ios::binary | std::ios::ate);
     if (!inFile) {
-        std::cout << "[ERROR] Cannot open input file!\n";
-        return;
+        *out_ << "[ERROR] Cannot open input file!\n";
+        return false;
     }
     fileSize_ = inFile.tellg();
-    std::cout << "[INFO] Compressed file size: " << fileSize_ << " bytes" << std::endl;
-    inFile.seekg(0, std::ios::beg);
-    // Chunk sayısı tahmini: Sıkıştırılmış dosyada chunk sınırları bilinmiyor, bu nedenle decompress işlemi için ek meta veri gerekir.
-    // Şimdilik tüm dosyayı tek chunk olarak açıyoruz (singlethread) veya eşit parçalara bölüp decompress ediyoruz (multithread, veri bozulabilir!)
-    if (!multithread) {
-        std::vector<char> compressedData(fileSize_);
-        inFile.read(compressedData.data(), fileSize_);
-        std::vector<char> decompressed = runLengthDecode(compressedData);
-        std::ofstream outFile(outputFile_, std::ios::binary);
-        if (!outFile) {
-            std::cout << "[ERROR] Cannot open output file!\n";
-            return;
-        }
-        outFile.write(decompressed.data(), decompressed.size());
-        std::cout << "[INFO] Decompression finished!\n";
-        return;
+    *out_ << "[INFO] Compressed file size: " << fileSize_ << " bytes" << std::endl;
+    std::vector<ChunkEntry> index;
+    ContainerStatus status = readContainer(inFile, index);
+    if (status == ContainerStatus::Corrupt) {
+        corrupt_ = true;
+        return false;
+    }
+    bool indexed = (status == ContainerStatus::Valid);
+    if (!indexed) {
+        // İndekssiz (eski) dosya: chunk sınırları bilinmediği için tek thread'de tüm dosya tek chunk olarak,
+        // multithread'de chunkSize kadar parçalara bölünerek açılır
+        *out_ << "[WARN] Compressed file has no chunk index, checksums will not be verified\n";
+        size_t legacyChunkSize = multithread ? chunkSize_ : std::max<size_t>(fileSize_, 1);
+        chunkCount_ = (fileSize_ + legacyChunkSize - 1) / legacyChunkSize;
+        index.resize(chunkCount_);
+        for (size_t i = 0; i < chunkCount_; ++i) {
+            index[i].offset = i * legacyChunkSize;
+            index[i].compressedSize = std::min(legacyChunkSize, fileSize_ - i * legacyChunkSize);
+        }
     }
-    // Multithread decompress için: Dosyayı chunkSize kadar parçalara bölüp her birini ayrı thread ile açıyoruz
-    chunkCount_ = (fileSize_ + chunkSize_ - 1) / chunkSize_;
     std::vector<std::vector<char>> decompressedChunks(chunkCount_);
-    std::vector<std::thread> threads(chunkCount_);
-    std::vector<bool> chunkDone(chunkCount_, false);
-    progressBar_ = new ProgressBar(chunkCount_);
-    for (size_t i = 0; i < chunkCount_; ++i) {
-        size_t thisChunkSize = std::min(chunkSize_, fileSize_ - i * chunkSize_);
-        std::vector<char> chunkData(thisChunkSize);
-        inFile.read(chunkData.data(), thisChunkSize);
-        threads[i] = std::thread([this, i, chunkData, &decompressedChunks, &chunkDone]() mutable {
-            std::vector<char> decompressed;
-            this->decompressChunk(i, chunkData, decompressed);
+    std::vector<std::string> chunkErrors(chunkCount_);
+    if (!multithread) {
+        std::vector<char> chunkData;
+        for (size_t i = 0; i < chunkCount_; ++i) {
+            readChunk(inFile, index[i], chunkData);
+            decompressChunk(indexed ? &index[i] : nullptr, chunkData, decompressedChunks[i], chunkErrors[i]);
+        }
+    } else {
+        // Multithread decompress: her chunk indeksteki konumundan okunup ayrı thread ile açılır
+        std::vector<bool> chunkDone(chunkCount_, false);
+        ChunkTasks tasks(pool_);
+        if (out_ == &std::cout) {
+            progressBar_ = new ProgressBar(chunkCount_);
+        }
+        for (size_t i = 0; i < chunkCount_; ++i) {
+            std::vector<char> chunkData = acquireBuffer(0);
+            readChunk(inFile, index[i], chunkData);
+            const ChunkEntry* entry = indexed ? &index[i] : nullptr;
+            tasks.run([this, i, entry, chunkData = std::move(chunkData), &decompressedChunks, &chunkErrors, &chunkDone]() mutable {
+                std::vector<char> decompressed = this->acquireBuffer(0);
+                std::string error;
+                this->decompressChunk(entry, chunkData, decompressed, error);
+                this->releaseBuffer(std::move(chunkData));
+                {
+                    std::lock_guard<std::mutex> lock(this->writeMutex_);
+                    decompressedChunks[i] = std::move(decompressed);
+                    chunkErrors[i] = std::move(error);
+                    chunkDone[i] = true;
+                }
+            });
+        }
+        // Ana thread ilerleme çubuğunu günceller
+        size_t lastProgress = progressBar_ ? 0 : chunkCount_;
+        while (lastProgress < chunkCount_) {
+            size_t done = 0;
             {
-                std::lock_guard<std::mutex> lock(this->writeMutex_);
-                decompressedChunks[i] = std::move(decompressed);
-                chunkDone[i] = true;
+                std::lock_guard<std::mutex> lock(writeMutex_);
+                for (size_t i = 0; i < chunkCount_; ++i) {
+                    if (chunkDone[i]) ++done;
+                }
             }
-        });
-    }
-    // Ana thread ilerleme çubuğunu günceller
-    size_t lastProgress = 0;
-    while (lastProgress < chunkCount_) {
-        size_t done = 0;
-        {
-            std::lock_guard<std::mutex> lock(writeMutex_);
-            for (size_t i = 0; i < chunkCount_; ++i) {
-                if (chunkDone[i]) ++done;
+            if (done > lastProgress) {
+                progressBar_->update(done);
+                lastProgress = done;
             }
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
         }
-        if (done > lastProgress) {
-            progressBar_->update(done);
-            lastProgress = done;
+        tasks.join();
+        if (progressBar_) {
+            progressBar_->done();
+            delete progressBar_;
+            progressBar_ = nullptr;
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
     }
-    for (auto& t : threads) t.join();
-    progressBar_->done();
-    delete progressBar_;
-    std::ofstream outFile(outputFile_, std::ios::binary);
+    for (size_t i = 0; i < chunkCount_; ++i) {
+        if (!chunkErrors[i].empty()) {
+            *out_ << "[ERROR] Chunk " << i << " (offset " << index[i].offset << "): " << chunkErrors[i] << std::endl;
+            corrupt_ = true;
+        }
+    }
+    if (corrupt_) {
+        *out_ << "[ERROR] Decompression aborted, compressed file is corrupt!\n";
+        return false;
+    }
+    std::ofstream outFile;
+    bool sparse = openSparseOutput(outFile);
     if (!outFile) {
-        std::cout << "[ERROR] Cannot open output file!\n";
-        return;
+        *out_ << "[ERROR] Cannot open output file!\n";
+        return false;
     }
-    for (const auto& chunk : decompressedChunks) {
-        outFile.write(chunk.data(), chunk.size());
+    for (auto& chunk : decompressedChunks) {
+        writeSparse(outFile, chunk, sparse);
+        releaseBuffer(std::move(chunk));
+    }
+    if (!finishSparse(outFile, sparse)) {
+        *out_ << "[ERROR] Failed to write output file!\n";
+        return false;
+    }
+    *out_ << "[INFO] Decompression finished!\n";
+    return true;
+}
+
+bool Compressor::verify(bool multithread) {
+    corrupt_ = false;
+    *out_ << "[INFO] Verifying compressed file: " << inputFile_ << std::endl;
+    std::ifstream inFile(inputFile_, std::ios::binary | std::ios::ate);
+    if (!inFile) {
+        *out_ << "[ERROR] Cannot open input file!\n";
+        return false;
+    }
+    fileSize_ = inFile.tellg();
+    std::vector<ChunkEntry> index;
+    ContainerStatus status = readContainer(inFile, index);
+    if (status == ContainerStatus::Legacy) {
+        *out_ << "[ERROR] Compressed file has no chunk index, it can only be checked against the original file\n";
+        return false;
+    }
+    if (status == ContainerStatus::Corrupt) {
+        corrupt_ = true;
+        return false;
+    }
+    inFile.close();
+    *out_ << "[INFO] Chunk count: " << chunkCount_ << ", CRC32C: "
+              << (crc32cHardwareAccelerated() ? "hardware (SSE4.2)" : "software") << std::endl;
+    // Her worker kendi dosya akışıyla sıradaki chunk'ı alır, sonuçlar chunk indeksine göre saklanır
+    // Ardışık chunk'lar yaklaşık VERIFY_BATCH_BYTES boyutunda gruplara (batch) bölünür, her batch tek dosya akışıyla okunur.
+    // Paylaşılan havuzda her batch ayrı bir görevdir, böylece doğrulama worker'ları diğer isteklerle sırayla paylaşır.
+    std::vector<size_t> batchStart;
+    uint64_t batchBytes = 0;
+    for (size_t i = 0; i < chunkCount_; ++i) {
+        if (batchStart.empty() || batchBytes >= VERIFY_BATCH_BYTES) {
+            batchStart.push_back(i);
+            batchBytes = 0;
+        }
+        batchBytes += index[i].compressedSize;
+    }
+    size_t batchCount = batchStart.size();
+    batchStart.push_back(chunkCount_);
+    std::vector<std::string> chunkErrors(chunkCount_);
+    std::atomic<size_t> doneCount(0);
+    auto verifyBatch = [this, &index, &batchStart, &chunkErrors, &doneCount](size_t batch) {
+        std::ifstream chunkFile(inputFile_, std::ios::binary);
+        std::vector<char> chunkData = this->acquireBuffer(0);
+        for (size_t i = batchStart[batch]; i < batchStart[batch + 1]; ++i) {
+            this->readChunk(chunkFile, index[i], chunkData);
+            chunkErrors[i] = this->checkCompressedChunk(index[i], chunkData);
+            ++doneCount;
+        }
+        this->releaseBuffer(std::move(chunkData));
+    };
+    if (!multithread) {
+        for (size_t b = 0; b < batchCount; ++b) verifyBatch(b);
+    } else {
+        std::atomic<size_t> nextBatch(0);
+        ChunkTasks tasks(pool_);
+        if (pool_) {
+            for (size_t b = 0; b < batchCount; ++b) {
+                tasks.run([&verifyBatch, b]() { verifyBatch(b); });
+            }
+        } else {
+            // Havuz yoksa çekirdek sayısı kadar thread sıradaki batch'i alır
+            size_t workerCount = std::min<size_t>(batchCount, std::max(1u, std::thread::hardware_concurrency()));
+            for (size_t w = 0; w < workerCount; ++w) {
+                tasks.run([&verifyBatch, &nextBatch, batchCount]() {
+                    for (size_t b = nextBatch++; b < batchCount; b = nextBatch++) verifyBatch(b);
+                });
+            }
+        }
+        // Ana thread ilerleme çubuğunu günceller
+        if (out_ == &std::cout) {
+            progressBar_ = new ProgressBar(chunkCount_);
+        }
+        size_t lastProgress = progressBar_ ? 0 : chunkCount_;
+        while (lastProgress < chunkCount_) {
+            size_t done = doneCount;
+            if (done > lastProgress) {
+                progressBar_->update(done);
+                lastProgress = done;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        tasks.join();
+        if (progressBar_) {
+            progressBar_->done();
+            delete progressBar_;
+            progressBar_ = nullptr;
+        }
+    }
+    size_t corruptCount = 0;
+    for (size_t i = 0; i < chunkCount_; ++i) {
+        if (!chunkErrors[i].empty()) {
+            *out_ << "[ERROR] Chunk " << i << " (offset " << index[i].offset << ", "
+                      << index[i].compressedSize << " bytes): " << chunkErrors[i] << std::endl;
+            ++corruptCount;
+        }
+    }
+    if (corruptCount > 0) {
+        corrupt_ = true;
+        *out_ << "[REPORT] Verification failed: " << corruptCount << " of " << chunkCount_ << " chunks corrupt\n";
+        return false;
     }
-    std::cout << "[INFO] Decompression finished!\n";
+    *out_ << "[REPORT] Verification passed: all " << chunkCount_ << " chunks OK\n";
+    return true;
 }
 
-double Compressor::benchmark(void (Compressor::*func)(bool), Compressor& obj, bool multithread) {
+double Compressor::benchmark(bool (Compressor::*func)(bool), Compressor& obj, bool multithread, bool* succeeded) {
     auto start = std::chrono::high_resolution_clock::now();
-    (obj.*func)(multithread);
+    bool ok = (obj.*func)(multithread);
+    if (succeeded) *succeeded = ok;
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> diff = end - start;
     return diff.count();
@@ -3,27 +3,80 @@
 #include <vector>
 #include <thread>
 #include <mutex>
+#include <fstream>
+#include <cstdint>
+#include <ostream>
 #include "progress_bar.h"
 #include <chrono>
 
+// Minimum ve maksimum chunk size değerleri (bytes)
+constexpr size_t MIN_CHUNK_SIZE = 1024;        // 1KB
+constexpr size_t MAX_CHUNK_SIZE = 1024*1024*1024; // 1GB
+
+class ThreadPool;
+class BufferPool;
+
+// Sıkıştırılmış dosyadaki her chunk için indeks kaydı
+struct ChunkEntry {
+    uint64_t rawSize = 0;
+    uint64_t compressedSize = 0;
+    uint32_t rawCrc = 0;        // Orijinal (açılmış) verinin CRC32C değeri
+    uint32_t compressedCrc = 0; // Sıkıştırılmış verinin CRC32C değeri
+    uint64_t offset = 0;        // Dosyadaki konumu (diske yazılmaz, okurken hesaplanır)
+};
+
 class Compressor {
 public:
-    Compressor(const std::string& inputFile, const std::string& outputFile, size_t chunkSize);
-    void compress(bool multithread = true);
-    void decompress(bool multithread = true);
+    // blockSort: sıkıştırmada her chunk'a RLE öncesi BWT + MTF uygulanır (metin için); açarken dosya başlığından okunur
+    Compressor(const std::string& inputFile, const std::string& outputFile, size_t chunkSize, bool blockSort = false);
+    // İşlem başarıyla tamamlanırsa true döner
+    bool compress(bool multithread = true);
+    bool decompress(bool multithread = true);
+    // Orijinal dosyaya ihtiyaç duymadan sıkıştırılmış dosyadaki tüm chunk'ları sağlama toplamlarıyla doğrular
+    bool verify(bool multithread = true);
+    // Son işlem sıkıştırılmış dosyada bozulma bulduysa true (çıkış kodu 2), diğer hatalarda false (çıkış kodu 1)
+    bool corruptionDetected() const { return corrupt_; }
+    // Daemon modu: chunk görevleri chunk başına yeni thread yerine paylaşılan havuzda çalışır,
+    // chunk tamponları havuzdan alınıp işler arasında yeniden kullanılır
+    void setThreadPool(ThreadPool* pool, BufferPool* buffers = nullptr);
+    // Log çıktısının yönlendirileceği akış (varsayılan std::cout); std::cout dışındaysa ilerleme çubuğu gösterilmez
+    void setOutput(std::ostream& out);
     // Benchmark ve karşılaştırma fonksiyonları
-    static double benchmark(void (Compressor::*func)(bool), Compressor& obj, bool multithread);
+    static double benchmark(bool (Compressor::*func)(bool), Compressor& obj, bool multithread, bool* succeeded = nullptr);
     static bool compareFiles(const std::string& file1, const std::string& file2);
 private:
+    enum class ContainerStatus { Legacy, Valid, Corrupt };
     std::string inputFile_;
     std::string outputFile_;
     size_t chunkSize_;
     size_t fileSize_;
     size_t chunkCount_;
+    bool blockSort_;
+    bool corrupt_;
     std::mutex writeMutex_;
     ProgressBar* progressBar_;
-    void compressChunk(size_t chunkIndex, const std::vector<char>& chunkData, std::vector<char>& compressedData);
-    void decompressChunk(size_t chunkIndex, const std::vector<char>& chunkData, std::vector<char>& decompressedData);
-    std::vector<char> runLengthEncode(const std::vector<char>& data);
-    std::vector<char> runLengthDecode(const std::vector<char>& data);
-}; 
\ No newline at end of file
+    ThreadPool* pool_;
+    BufferPool* buffers_;
+    std::ostream* out_;
+    std::vector<char> acquireBuffer(size_t size);
+    void releaseBuffer(std::vector<char>&& buffer);
+    void compressChunk(const std::vector<char>& chunkData, std::vector<char>& compressedData, ChunkEntry& entry);
+    bool decompressChunk(const ChunkEntry* entry, const std::vector<char>& chunkData,
+                         std::vector<char>& decompressedData, std::string& error);
+    void readChunk(std::ifstream& inFile, const ChunkEntry& entry, std::vector<char>& chunkData);
+    std::string checkCompressedChunk(const ChunkEntry& entry, const std::vector<char>& chunkData);
+    void runLengthEncode(const std::vector<char>& data, std::vector<char>& encoded);
+    void runLengthDecode(const char* data, size_t size, std::vector<char>& decoded);
+    // Chunk indeksli dosya formatı: başlık + indeks tablosu + sıkıştırılmış chunk'lar
+    bool writeContainer(const std::vector<ChunkEntry>& index, const std::vector<std::vector<char>>& chunks);
+    ContainerStatus readContainer(std::ifstream& inFile, std::vector<ChunkEntry>& index);
+    // Sparse çıktı: blok boyutunu aşan sıfır dizileri diske yazılmaz, dosyada boşluk (hole) olarak bırakılır
+    bool openSparseOutput(std::ofstream& outFile);
+    void writeSparse(std::ofstream& outFile, const std::vector<char>& data, bool sparse);
+    void writeSparseBlock(std::ofstream& outFile, const char* block, size_t offset);
+    bool finishSparse(std::ofstream& outFile, bool sparse);
+    size_t outputOffset_;
+    size_t holeBytes_;
+    bool pendingHole_;
+    std::vector<char> sparseTail_; // Henüz tamamlanmamış (chunk sınırına denk gelen) son blok
+};
@@ -0,0 +1,449 @@
+#include "daemon.h"
+#include "compressor.h"
+#include "thread_pool.h"
+#include "buffer_pool.h"
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <filesystem>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#ifdef _WIN32
+#define NOMINMAX
+#include <winsock2.h>
+#include <afunix.h>
+using SocketHandle = SOCKET;
+constexpr SocketHandle INVALID_SOCKET_HANDLE = INVALID_SOCKET;
+#else
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+using SocketHandle = int;
+constexpr SocketHandle INVALID_SOCKET_HANDLE = -1;
+#endif
+
+// İstemciden gelen istek satırının üst sınırı ve daemon'un tutacağı boş tampon belleği
+constexpr size_t MAX_REQUEST_SIZE = 64 * 1024;
+constexpr size_t DAEMON_BUFFER_POOL_BYTES = 256 * 1024 * 1024; // 256MB
+// Bağlanıp bu süre içinde istek satırını göndermeyen istemci kapatılır (boşta bağlantı daemon'un kapanmasını engellemesin)
+constexpr int REQUEST_TIMEOUT_SECONDS = 5;
+// accept() başarısız olduğunda yeniden denemeden önce beklenecek süre
+constexpr int ACCEPT_RETRY_DELAY_MS = 100;
+
+// Protokol: istemci alanları '\t' ile ayrılmış tek satır gönderir ("compress\tmulti\t<in>\t<out>\t<chunk>\n").
+// Daemon işlemin log satırlarını geldikçe geri gönderir, son satır "@exit <kod>" olur.
+constexpr char EXIT_PREFIX[] = "@exit ";
+
+namespace {
+
+void closeSocket(SocketHandle s) {
+#ifdef _WIN32
+    closesocket(s);
+#else
+    close(s);
+#endif
+}
+
+bool sendAll(SocketHandle s, const char* data, size_t size) {
+    while (size > 0) {
+#ifdef _WIN32
+        int sent = send(s, data, static_cast<int>(size), 0);
+#elif defined(MSG_NOSIGNAL)
+        ssize_t sent = send(s, data, size, MSG_NOSIGNAL);
+#else
+        ssize_t sent = send(s, data, size, 0);
+#endif
+        if (sent <= 0) return false;
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+int lastSocketError() {
+#ifdef _WIN32
+    return WSAGetLastError();
+#else
+    return errno;
+#endif
+}
+
+void setReceiveTimeout(SocketHandle s, int seconds) {
+#ifdef _WIN32
+    DWORD timeout = static_cast<DWORD>(seconds) * 1000;
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+#else
+    timeval timeout{};
+    timeout.tv_sec = seconds;
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+#endif
+}
+
+bool makeAddress(const std::string& socketPath, sockaddr_un& addr) {
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        std::cout << "[ERROR] Socket path is too long: " << socketPath << std::endl;
+        return false;
+    }
+    std::memcpy(addr.sun_path, socketPath.c_str(), socketPath.size());
+    return true;
+}
+
+// Socket yolunda dinleyen bir daemon olup olmadığını bağlanmayı deneyerek anlar.
+// Yalnızca bağlantı reddedildiğinde (veya yol yoksa) dosya önceki bir çalışmadan kalmış kabul edilir.
+enum class SocketState { Listening, Stale, Unknown };
+
+SocketState probeSocket(const sockaddr_un& addr) {
+    SocketHandle s = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (s == INVALID_SOCKET_HANDLE) return SocketState::Unknown;
+    SocketState state = SocketState::Listening;
+    if (connect(s, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+#ifdef _WIN32
+        int error = WSAGetLastError();
+        state = (error == WSAECONNREFUSED) ? SocketState::Stale : SocketState::Unknown;
+#else
+        int error = errno;
+        state = (error == ECONNREFUSED || error == ENOENT) ? SocketState::Stale : SocketState::Unknown;
+#endif
+    }
+    closeSocket(s);
+    return state;
+}
+
+bool initSockets() {
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        std::cout << "[ERROR] Failed to initialize Winsock\n";
+        return false;
+    }
+#endif
+    return true;
+}
+
+void cleanupSockets() {
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+// Compressor log çıktısını satır satır socket'e yazan akış tamponu
+class SocketStreamBuf : public std::streambuf {
+public:
+    explicit SocketStreamBuf(SocketHandle s) : socket_(s), failed_(false) {
+        setp(buffer_, buffer_ + sizeof(buffer_));
+    }
+    ~SocketStreamBuf() override { sync(); }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (flushBuffer() < 0) return traits_type::eof();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        std::streamsize written = std::streambuf::xsputn(s, n);
+        // Satır tamamlandıysa hemen gönder, istemci ilerlemeyi anlık görür
+        if (std::memchr(s, '\n', static_cast<size_t>(n))) flushBuffer();
+        return written;
+    }
+
+    int sync() override { return flushBuffer(); }
+
+private:
+    int flushBuffer() {
+        size_t n = static_cast<size_t>(pptr() - pbase());
+        if (n > 0 && !failed_) {
+            // İstemci bağlantıyı kapattıysa işlem yine tamamlanır, çıktı atılır
+            failed_ = !sendAll(socket_, pbase(), n);
+        }
+        setp(buffer_, buffer_ + sizeof(buffer_));
+        return failed_ ? -1 : 0;
+    }
+
+    SocketHandle socket_;
+    bool failed_;
+    char buffer_[4096];
+};
+
+bool readLine(SocketHandle s, std::string& line) {
+    line.clear();
+    char c;
+    while (line.size() < MAX_REQUEST_SIZE) {
+        if (recv(s, &c, 1, 0) != 1) return false;
+        if (c == '\n') return true;
+        line.push_back(c);
+    }
+    return false;
+}
+
+std::vector<std::string> splitFields(const std::string& line) {
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, '\t')) fields.push_back(field);
+    return fields;
+}
+
+// Tek bir isteği paylaşılan havuz ve tamponlarla çalıştırır, çıkış kodunu döndürür (CLI ile aynı anlamda)
+int handleRequest(const std::vector<std::string>& fields, std::ostream& out, ThreadPool& pool, BufferPool& buffers) {
+    std::string operation = fields.empty() ? "" : fields[0];
+    bool isVerify = (operation == "verify");
+    if (operation != "compress" && operation != "decompress" && !isVerify) {
+        out << "[ERROR] Invalid operation! Use 'compress', 'decompress' or 'verify'.\n";
+        return 1;
+    }
+    size_t expected = isVerify ? 3 : 5;
+    bool withOption = (operation == "compress" && fields.size() == expected + 1);
+    if (fields.size() != expected && !withOption) {
+        out << "[ERROR] Invalid number of arguments!\n";
+        return 1;
+    }
+    std::string mode = fields[1];
+    if (mode != "single" && mode != "multi") {
+        out << "[ERROR] Invalid mode! Use 'single' or 'multi'.\n";
+        return 1;
+    }
+    bool multithread = (mode == "multi");
+    std::string inputFile = fields[2];
+    std::string outputFile = isVerify ? "" : fields[3];
+    size_t chunkSize = isVerify ? MIN_CHUNK_SIZE : std::strtoull(fields[4].c_str(), nullptr, 10);
+    if (chunkSize < MIN_CHUNK_SIZE || chunkSize > MAX_CHUNK_SIZE) {
+        out << "[ERROR] Invalid chunk size! Must be between "
+            << MIN_CHUNK_SIZE << " and " << MAX_CHUNK_SIZE << " bytes.\n";
+        return 1;
+    }
+    if (withOption && fields[5] != "bwt") {
+        out << "[ERROR] Invalid option! Only 'bwt' is supported.\n";
+        return 1;
+    }
+    // Dosya erişim hataları Compressor tarafından dosya açılırken raporlanır, ayrıca test açılışı yapılmaz
+    try {
+        Compressor compressor(inputFile, outputFile, chunkSize, withOption);
+        compressor.setThreadPool(&pool, &buffers);
+        compressor.setOutput(out);
+        auto start = std::chrono::high_resolution_clock::now();
+        bool ok = false;
+        if (operation == "compress") {
+            ok = compressor.compress(multithread);
+        } else if (operation == "decompress") {
+            ok = compressor.decompress(multithread);
+        } else {
+            ok = compressor.verify(multithread);
+        }
+        int code = ok ? 0 : (compressor.corruptionDetected() ? 2 : 1);
+        double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        out << "[REPORT] " << (operation == "compress" ? "Compression" : operation == "decompress" ? "Decompression" : "Verification")
+            << " time: " << elapsed << " seconds\n";
+        return code;
+    } catch (const std::bad_alloc& e) {
+        out << "[ERROR] Memory allocation failed: " << e.what() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        out << "[ERROR] An error occurred: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+} // namespace
+
+int runDaemon(const std::string& socketPath, size_t threadCount) {
+    if (!initSockets()) return 1;
+#ifndef _WIN32
+    // Bağlantısı kopan istemciye yazmak süreci sonlandırmasın
+    std::signal(SIGPIPE, SIG_IGN);
+#endif
+    sockaddr_un addr;
+    if (!makeAddress(socketPath, addr)) return 1;
+
+    // Önceki çalışmadan kalan socket dosyasını temizle (normal dosya veya dizinlere, çalışan bir daemon'un socket'ine dokunma)
+    std::error_code ec;
+    if (std::filesystem::exists(socketPath, ec) && !std::filesystem::is_regular_file(socketPath, ec) &&
+        !std::filesystem::is_directory(socketPath, ec)) {
+        SocketState state = probeSocket(addr);
+        if (state == SocketState::Listening) {
+            std::cout << "[ERROR] A daemon is already running on " << socketPath << std::endl;
+            cleanupSockets();
+            return 1;
+        }
+        if (state == SocketState::Stale) {
+            std::filesystem::remove(socketPath, ec);
+        }
+    }
+
+    SocketHandle listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener == INVALID_SOCKET_HANDLE) {
+        std::cout << "[ERROR] Failed to create socket\n";
+        cleanupSockets();
+        return 1;
+    }
+    if (bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listener, 64) != 0) {
+        std::cout << "[ERROR] Failed to listen on socket: " << socketPath << std::endl;
+        closeSocket(listener);
+        cleanupSockets();
+        return 1;
+    }
+
+    ThreadPool pool(threadCount);
+    BufferPool buffers(DAEMON_BUFFER_POOL_BYTES);
+    std::mutex logMutex;
+    std::mutex activeMutex;
+    std::condition_variable activeDone;
+    size_t activeRequests = 0;
+    std::atomic<bool> stopping(false);
+    std::cout << "[INFO] Daemon listening on " << socketPath << " with " << pool.size() << " worker threads" << std::endl;
+
+    while (!stopping) {
+        SocketHandle client = accept(listener, nullptr, nullptr);
+        if (client == INVALID_SOCKET_HANDLE) {
+            int error = lastSocketError();
+            if (stopping) break;
+            // Kalıcı hatalarda (ör. dosya tanıtıcısı sınırı) döngü CPU'yu meşgul etmesin diye kısa süre beklenir
+            {
+                std::lock_guard<std::mutex> lock(logMutex);
+                std::cout << "[WARN] Failed to accept connection (error " << error << "), retrying" << std::endl;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(ACCEPT_RETRY_DELAY_MS));
+            continue;
+        }
+        setReceiveTimeout(client, REQUEST_TIMEOUT_SECONDS);
+        {
+            std::lock_guard<std::mutex> lock(activeMutex);
+            ++activeRequests;
+        }
+        try {
+            // Bağlantı thread'i yalnızca isteği okur ve koordine eder, chunk işleri paylaşılan havuzda çalışır
+            std::thread([client, listener, &pool, &buffers, &logMutex, &activeMutex, &activeDone, &activeRequests, &stopping]() {
+                std::string line;
+                if (readLine(client, line)) {
+                    std::vector<std::string> fields = splitFields(line);
+                    {
+                        std::lock_guard<std::mutex> lock(logMutex);
+                        std::cout << "[INFO] Request: " << line << std::endl;
+                    }
+                    SocketStreamBuf streamBuf(client);
+                    std::ostream out(&streamBuf);
+                    int code = 0;
+                    if (fields.size() == 1 && fields[0] == "shutdown") {
+                        out << "[INFO] Daemon shutting down\n";
+                        stopping = true;
+#ifdef _WIN32
+                        closesocket(listener);
+#else
+                        shutdown(listener, SHUT_RDWR);
+#endif
+                    } else {
+                        code = handleRequest(fields, out, pool, buffers);
+                    }
+                    out << EXIT_PREFIX << code << std::endl;
+                }
+                closeSocket(client);
+                std::lock_guard<std::mutex> lock(activeMutex);
+                if (--activeRequests == 0) activeDone.notify_all();
+            }).detach();
+        } catch (const std::system_error& e) {
+            // Thread oluşturulamadıysa (ör. kaynak sınırı) bağlantı reddedilir, daemon çalışmaya devam eder
+            {
+                std::lock_guard<std::mutex> lock(logMutex);
+                std::cout << "[ERROR] Failed to start connection thread: " << e.what() << std::endl;
+            }
+            closeSocket(client);
+            std::lock_guard<std::mutex> lock(activeMutex);
+            if (--activeRequests == 0) activeDone.notify_all();
+        }
+    }
+
+    // Devam eden isteklerin bitmesini bekle
+    {
+        std::unique_lock<std::mutex> lock(activeMutex);
+        activeDone.wait(lock, [&activeRequests]() { return activeRequests == 0; });
+    }
+#ifndef _WIN32
+    closeSocket(listener);
+#endif
+    std::filesystem::remove(socketPath, ec);
+    cleanupSockets();
+    std::cout << "[INFO] Daemon stopped\n";
+    return 0;
+}
+
+int runClient(const std::string& socketPath, const std::vector<std::string>& request) {
+    // Daemon farklı bir çalışma dizininde olabileceği için dosya yolları mutlak yola çevrilir
+    std::vector<std::string> fields = request;
+    size_t pathCount = (!fields.empty() && fields[0] == "verify") ? 1 : 2;
+    for (size_t i = 2; i < fields.size() && i < 2 + pathCount; ++i) {
+        std::error_code ec;
+        std::filesystem::path absolute = std::filesystem::absolute(fields[i], ec);
+        if (!ec) fields[i] = absolute.string();
+    }
+    std::string line;
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].find_first_of("\t\n") != std::string::npos) {
+            std::cout << "[ERROR] Arguments must not contain tab or newline characters\n";
+            return 1;
+        }
+        if (i > 0) line += '\t';
+        line += fields[i];
+    }
+    line += '\n';
+
+    if (!initSockets()) return 1;
+    sockaddr_un addr;
+    if (!makeAddress(socketPath, addr)) return 1;
+    SocketHandle s = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (s == INVALID_SOCKET_HANDLE || connect(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        std::cout << "[ERROR] Cannot connect to daemon at " << socketPath << std::endl;
+        if (s != INVALID_SOCKET_HANDLE) closeSocket(s);
+        cleanupSockets();
+        return 1;
+    }
+    if (!sendAll(s, line.data(), line.size())) {
+        std::cout << "[ERROR] Failed to send request to daemon\n";
+        closeSocket(s);
+        cleanupSockets();
+        return 1;
+    }
+
+    // Daemon'un çıktısını geldikçe aktar, "@exit" satırından çıkış kodunu al
+    int exitCode = 1;
+    bool finished = false;
+    std::string pending;
+    char buffer[4096];
+    for (;;) {
+        int received = static_cast<int>(recv(s, buffer, sizeof(buffer), 0));
+        if (received <= 0) break;
+        pending.append(buffer, static_cast<size_t>(received));
+        size_t pos;
+        while ((pos = pending.find('\n')) != std::string::npos) {
+            std::string out = pending.substr(0, pos);
+            pending.erase(0, pos + 1);
+            if (out.compare(0, sizeof(EXIT_PREFIX) - 1, EXIT_PREFIX) == 0) {
+                exitCode = std::atoi(out.c_str() + sizeof(EXIT_PREFIX) - 1);
+                finished = true;
+            } else {
+                std::cout << out << std::endl;
+            }
+        }
+    }
+    closeSocket(s);
+    cleanupSockets();
+    if (!finished) {
+        std::cout << "[ERROR] Connection to daemon closed before the request finished\n";
+        return 1;
+    }
+    return exitCode;
+}
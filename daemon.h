@@ -0,0 +1,12 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Daemon modu: worker havuzu ve chunk tamponları süreç boyunca sıcak tutulur,
+// compress/decompress/verify istekleri yerel bir Unix domain socket üzerinden alınır.
+// Aynı anda gelen isteklerin chunk görevleri paylaşılan havuzda sırayla (round-robin) çalıştırılır.
+int runDaemon(const std::string& socketPath, size_t threadCount);
+
+// İstemci modu: isteği daemon'a gönderir, daemon'un log çıktısını geldikçe ekrana yazar
+// ve işlemin çıkış kodunu döndürür. request: "compress multi <in> <out> <chunk> [bwt]" gibi argümanlar
+int runClient(const std::string& socketPath, const std::vector<std::string>& request);
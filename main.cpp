@@ -8,14 +8,18 @@
 #include <iomanip>
 #include "compressor.h"
 #include "progress_bar.h"
-
-// Minimum ve maksimum chunk size değerleri (bytes)
-constexpr size_t MIN_CHUNK_SIZE = 1024;        // 1KB
-constexpr size_t MAX_CHUNK_SIZE = 1024*1024*1024; // 1GB
+#include "daemon.h"
 
 void printUsage(const char* progName) {
-    std::cout << "Usage: " << progName << " <compress|decompress> <single|multi> <input_file> <output_file> <chunk_size_in_bytes>\n";
+    std::cout << "Usage: " << progName << " <compress|decompress> <single|multi> <input_file> <output_file> <chunk_size_in_bytes> [bwt]\n";
+    std::cout << "       " << progName << " verify <single|multi> <compressed_file>\n";
+    std::cout << "       " << progName << " daemon <socket_path> [worker_threads]\n";
+    std::cout << "       " << progName << " client <socket_path> <compress|decompress|verify> <arguments...>\n";
     std::cout << "Example: " << progName << " compress multi input/bigfile.txt output/bigfile.compressed 1048576\n";
+    std::cout << "Example: " << progName << " verify multi output/bigfile.compressed\n";
+    std::cout << "Example: " << progName << " client compressor.sock compress multi input/bigfile.txt output/bigfile.compressed 1048576\n";
+    std::cout << "\nOptions:\n";
+    std::cout << "  bwt: Apply Burrows-Wheeler + move-to-front transform before RLE (compress only, better for text)\n";
     std::cout << "\nChunk size limits:\n";
     std::cout << "  Minimum: " << MIN_CHUNK_SIZE << " bytes (1KB)\n";
     std::cout << "  Maximum: " << MAX_CHUNK_SIZE << " bytes (1GB)\n";
@@ -216,7 +220,54 @@ int main(int argc, char* argv[]) {
     std::cout << "Multithreaded File Compression Utility\n";
     std::cout << "-------------------------------------\n";
 
-    if (argc != 6) {
+    if (argc >= 3 && std::string(argv[1]) == "daemon") {
+        // Daemon mode: keeps the worker pool and buffers warm, serves requests over a Unix domain socket
+        size_t threadCount = (argc >= 4) ? std::strtoull(argv[3], nullptr, 10) : std::thread::hardware_concurrency();
+        if (threadCount == 0) {
+            std::cout << "[ERROR] Invalid worker thread count!\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+        return runDaemon(argv[2], threadCount);
+    }
+
+    if (argc >= 4 && std::string(argv[1]) == "client") {
+        // Client mode: sends the request to a running daemon and streams its output back
+        std::vector<std::string> request(argv + 3, argv + argc);
+        return runClient(argv[2], request);
+    }
+
+    if (argc == 4 && std::string(argv[1]) == "verify") {
+        // Verify mode: checks every chunk against its stored checksums, no original file needed
+        std::string mode = argv[2];
+        std::string inputFile = argv[3];
+        if (mode != "single" && mode != "multi") {
+            std::cout << "[ERROR] Invalid mode! Use 'single' or 'multi'.\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (!std::filesystem::exists(inputFile)) {
+            std::cout << "[ERROR] Input file does not exist: " << inputFile << std::endl;
+            return 1;
+        }
+        if (!checkFilePermissions(inputFile, false) || !testFileAccess(inputFile, false)) {
+            std::cout << "[ERROR] Cannot access input file: " << inputFile << std::endl;
+            return 1;
+        }
+        try {
+            Compressor compressor(inputFile, "", MIN_CHUNK_SIZE);
+            auto start = std::chrono::high_resolution_clock::now();
+            bool ok = compressor.verify(mode == "multi");
+            double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+            std::cout << "[REPORT] Verification time: " << elapsed << " seconds\n";
+            return ok ? 0 : (compressor.corruptionDetected() ? 2 : 1);
+        } catch (const std::exception& e) {
+            std::cout << "[ERROR] An error occurred: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if (argc != 6 && argc != 7) {
         std::cout << "[ERROR] Invalid number of arguments!\n";
         printUsage(argv[0]);
         return 1;
@@ -227,10 +278,11 @@ int main(int argc, char* argv[]) {
     std::string inputFile = argv[3];
     std::string outputFile = argv[4];
     size_t chunkSize = std::strtoull(argv[5], nullptr, 10);
+    std::string option = (argc == 7) ? argv[6] : "";
 
     // Operation check
     if (operation != "compress" && operation != "decompress") {
-        std::cout << "[ERROR] Invalid operation! Use 'compress' or 'decompress'.\n";
+        std::cout << "[ERROR] Invalid operation! Use 'compress', 'decompress' or 'verify'.\n";
         printUsage(argv[0]);
         return 1;
     }
@@ -242,6 +294,16 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // Option check
+    if (!option.empty() && option != "bwt") {
+        std::cout << "[ERROR] Invalid option! Only 'bwt' is supported.\n";
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (option == "bwt" && operation != "compress") {
+        std::cout << "[WARN] 'bwt' option is only used when compressing, decompression reads it from the file header\n";
+    }
+
     // Chunk size check
     if (chunkSize < MIN_CHUNK_SIZE || chunkSize > MAX_CHUNK_SIZE) {
         std::cout << "[ERROR] Invalid chunk size! Must be between " 
@@ -282,21 +344,26 @@ int main(int argc, char* argv[]) {
             return 1;
         }
 
-        Compressor compressor(inputFile, outputFile, chunkSize);
+        Compressor compressor(inputFile, outputFile, chunkSize, option == "bwt");
 
         // Benchmark and comparison
         double elapsed = 0.0;
+        bool succeeded = false;
         if (operation == "compress") {
-            std::cout << "[INFO] Compression mode: " << (multithread ? "Multithreaded" : "Singlethreaded") << std::endl;
+            std::cout << "[INFO] Compression mode: " << (multithread ? "Multithreaded" : "Singlethreaded")
+                      << (option == "bwt" ? " + BWT/MTF" : "") << std::endl;
             std::cout << "[INFO] Output file: " << outputFile << std::endl;
-            elapsed = Compressor::benchmark(&Compressor::compress, compressor, multithread);
+            elapsed = Compressor::benchmark(&Compressor::compress, compressor, multithread, &succeeded);
             std::cout << "[REPORT] Compression time: " << elapsed << " seconds\n";
         } else if (operation == "decompress") {
             std::cout << "[INFO] Decompression mode: " << (multithread ? "Multithreaded" : "Singlethreaded") << std::endl;
             std::cout << "[INFO] Output file: " << outputFile << std::endl;
-            elapsed = Compressor::benchmark(&Compressor::decompress, compressor, multithread);
+            elapsed = Compressor::benchmark(&Compressor::decompress, compressor, multithread, &succeeded);
             std::cout << "[REPORT] Decompression time: " << elapsed << " seconds\n";
         }
+        if (!succeeded) {
+            return compressor.corruptionDetected() ? 2 : 1;
+        }
 
         // Compare decompressed files with each other and input
         if (operation == "decompress") {
@@ -317,7 +384,8 @@ int main(int argc, char* argv[]) {
                 bool same = Compressor::compareFiles(inputRef, outputFile);
                 std::cout << "[REPORT] Decompressed file vs input: " << (same ? "MATCH" : "DIFFER") << std::endl;
             } else {
-                std::cout << "[WARN] Reference file for comparison not found: " << inputRef << std::endl;
+                std::cout << "[INFO] Reference file for comparison not found: " << inputRef
+                          << " (chunk checksums were checked during decompression)" << std::endl;
             }
         }
     } catch (const std::bad_alloc& e) {
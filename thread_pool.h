@@ -0,0 +1,113 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Sabit sayıda worker thread'i olan havuz.
+// Her iş (ör. daemon'daki bir istek) kendi görev grubunu açar; worker'lar görev bekleyen gruplar arasında
+// sırayla (round-robin) birer görev alır, böylece çok chunk'lı büyük bir iş aynı anda gelen küçük işleri bekletmez.
+class ThreadPool {
+public:
+    class Group {
+    private:
+        friend class ThreadPool;
+        std::queue<std::function<void()>> tasks_;
+        size_t pending_ = 0;      // Kuyrukta bekleyen + çalışan görev sayısı
+        bool scheduled_ = false;  // Grup şu an sıra (ring) içinde mi
+        std::exception_ptr error_;
+        std::condition_variable done_;
+    };
+
+    explicit ThreadPool(size_t threadCount) : stop_(false) {
+        if (threadCount == 0) threadCount = 1;
+        for (size_t i = 0; i < threadCount; ++i) {
+            workers_.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& t : workers_) t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers_.size(); }
+
+    std::shared_ptr<Group> createGroup() { return std::make_shared<Group>(); }
+
+    void submit(const std::shared_ptr<Group>& group, std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            group->tasks_.push(std::move(task));
+            ++group->pending_;
+            if (!group->scheduled_) {
+                ring_.push_back(group);
+                group->scheduled_ = true;
+            }
+        }
+        cv_.notify_one();
+    }
+
+    // Gruptaki tüm görevler bitene kadar bekler; görevlerden biri exception fırlattıysa burada tekrar fırlatılır
+    void wait(const std::shared_ptr<Group>& group) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        group->done_.wait(lock, [&group]() { return group->pending_ == 0; });
+        if (group->error_) {
+            std::exception_ptr error = group->error_;
+            group->error_ = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    void workerLoop() {
+        for (;;) {
+            std::shared_ptr<Group> group;
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]() { return stop_ || !ring_.empty(); });
+                if (ring_.empty()) return;
+                group = ring_.front();
+                ring_.pop_front();
+                task = std::move(group->tasks_.front());
+                group->tasks_.pop();
+                // Grupta görev kaldıysa sıranın sonuna geri ekle
+                if (!group->tasks_.empty()) {
+                    ring_.push_back(group);
+                } else {
+                    group->scheduled_ = false;
+                }
+            }
+            std::exception_ptr error;
+            try {
+                task();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (error && !group->error_) group->error_ = error;
+                if (--group->pending_ == 0) group->done_.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::deque<std::shared_ptr<Group>> ring_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_;
+};